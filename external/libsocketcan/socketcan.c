@@ -164,12 +164,13 @@ int16_t socketcanPush(const SocketCANFD fd, const CanardFrame* const frame, cons
     return poll_result;
 }
 
-int16_t socketcanPop(const SocketCANFD       fd,
-                     CanardFrame* const      out_frame,
-                     const size_t            payload_buffer_size,
-                     void* const             payload_buffer,
-                     const CanardMicrosecond timeout_usec,
-                     bool* const             loopback)
+int16_t socketcanPop(const SocketCANFD        fd,
+                     CanardFrame* const       out_frame,
+                     CanardMicrosecond* const out_timestamp_usec,
+                     const size_t             payload_buffer_size,
+                     void* const              payload_buffer,
+                     const CanardMicrosecond  timeout_usec,
+                     bool* const              loopback)
 {
     if ((out_frame == NULL) || (payload_buffer == NULL))
     {
@@ -258,6 +259,10 @@ int16_t socketcanPop(const SocketCANFD       fd,
             return -EIO;
         }
 
+        if (out_timestamp_usec != NULL)
+        {
+            *out_timestamp_usec = (CanardMicrosecond) (((uint64_t) tv.tv_sec * 1000000ULL) + (uint64_t) tv.tv_usec);
+        }
         (void) memset(out_frame, 0, sizeof(CanardFrame));
         out_frame->extended_can_id = sockcan_frame.can_id & CAN_EFF_MASK;
         out_frame->payload_size    = sockcan_frame.len;
@@ -58,18 +58,21 @@ int16_t socketcanPush(const SocketCANFD fd, const CanardFrame* const frame, cons
 /// The payload pointer of the returned frame will point to the payload_buffer. It can be a stack-allocated array.
 /// The payload_buffer_size shall be large enough (64 bytes is enough for CAN FD), otherwise an error is returned.
 /// The received frame timestamp will be set to CLOCK_REALTIME by the kernel, sampled near the moment of its arrival.
+/// It is written to out_timestamp_usec unless the pointer is NULL. For looped-back frames this is the moment the
+/// frame has left the local transmit queue, i.e. it can be used as a transmission timestamp (e.g. for time sync).
 /// The loopback flag pointer is used to both indicate and control behavior when a looped-back message is received.
 /// If the flag pointer is NULL, loopback frames are silently dropped; if not NULL, they are accepted and indicated
 /// using this flag.
 /// The function will block until a frame is received or until the timeout is expired. It may return early.
 /// Zero timeout makes the operation non-blocking.
 /// Returns 1 on success, 0 on timeout, negated errno on error.
-int16_t socketcanPop(const SocketCANFD       fd,
-                     CanardFrame* const      out_frame,
-                     const size_t            payload_buffer_size,
-                     void* const             payload_buffer,
-                     const CanardMicrosecond timeout_usec,
-                     bool* const             loopback);
+int16_t socketcanPop(const SocketCANFD        fd,
+                     CanardFrame* const       out_frame,
+                     CanardMicrosecond* const out_timestamp_usec,
+                     const size_t             payload_buffer_size,
+                     void* const              payload_buffer,
+                     const CanardMicrosecond  timeout_usec,
+                     bool* const              loopback);
 
 /// The configuration of a single extended 29-bit data frame acceptance filter.
 /// Bits above the 29-th shall be cleared.
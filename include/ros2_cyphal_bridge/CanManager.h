@@ -13,13 +13,19 @@
 
 #include <socketcan.h>
 
+#include <deque>
+#include <array>
+#include <mutex>
 #include <string>
 #include <thread>
 #include <atomic>
+#include <chrono>
 #include <functional>
 
 #include <rclcpp/rclcpp.hpp>
 
+#include "Transport.h"
+
 /**************************************************************************************
  * NAMESPACE
  **************************************************************************************/
@@ -31,30 +37,55 @@ namespace l3xz
  * CLASS DECLARATION
  **************************************************************************************/
 
-class CanManager
+class CanManager : public Transport
 {
 public:
-  typedef std::function<void(CanardFrame const &)> OnCanFrameReceivedFunc;
-
   CanManager(rclcpp::Logger const logger,
              std::string const & iface_name,
-             OnCanFrameReceivedFunc on_can_frame_received);
-  ~CanManager();
+             OnFrameReceivedFunc on_can_frame_received,
+             OnFrameTransmittedFunc on_can_frame_transmitted);
+  virtual ~CanManager();
 
 
-  bool transmit(CanardFrame const & frame);
+  virtual bool transmit(CanardFrame const & frame) override;
+  virtual void flush() override;
 
 
 private:
+  static size_t constexpr TX_QUEUE_SIZE = 256;
+  static std::chrono::milliseconds constexpr TX_TIMEOUT{1000};
+  static std::chrono::milliseconds constexpr TX_DROP_LOG_PERIOD{1000};
+
+  struct TxFrame
+  {
+    uint32_t extended_can_id;
+    size_t payload_size;
+    std::array<uint8_t, CANARD_MTU_CAN_FD> payload;
+    std::chrono::steady_clock::time_point deadline;
+  };
+
   rclcpp::Logger const _logger;
   std::string const IFACE_NAME;
   bool const IS_CAN_FD;
   int _socket_can_fd;
-  OnCanFrameReceivedFunc _on_can_frame_received;
+  OnFrameReceivedFunc _on_can_frame_received;
+  OnFrameTransmittedFunc _on_can_frame_transmitted;
+
+  std::mutex _tx_mtx;
+  std::deque<TxFrame> _tx_queue;
+  /* Dropped frames are counted and reported at most once per
+   * TX_DROP_LOG_PERIOD, a bus which is down or saturated would
+   * otherwise produce hundreds of log lines per second.
+   */
+  size_t _tx_drop_cnt_queue_full, _tx_drop_cnt_timeout;
+  int16_t _tx_last_error;
+  std::chrono::steady_clock::time_point _prev_tx_drop_log_timepoint;
+  void log_tx_drops(std::chrono::steady_clock::time_point const now);
 
   std::atomic<bool> _rx_thread_active;
   std::thread _rx_thread;
   void rx_thread_func();
+  void on_frame(CanardFrame const & frame, CanardMicrosecond const timestamp_usec, bool const is_loopback);
 };
 
 /**************************************************************************************
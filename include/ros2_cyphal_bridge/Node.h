@@ -11,9 +11,13 @@
  * INCLUDES
  **************************************************************************************/
 
+#include <map>
 #include <mutex>
+#include <atomic>
 #include <chrono>
 #include <memory>
+#include <vector>
+#include <optional>
 
 #include <rclcpp/rclcpp.hpp>
 
@@ -27,10 +31,19 @@
 #include <std_msgs/msg/u_int64.hpp>
 #include <std_msgs/msg/u_int16_multi_array.hpp>
 
+#include <trajectory_msgs/msg/joint_trajectory.hpp>
+
+#include <diagnostic_msgs/msg/diagnostic_array.hpp>
+
 #include <ros2_heartbeat/publisher/Publisher.h>
 #include <ros2_loop_rate_monitor/Monitor.h>
 
 #include "CanManager.h"
+#include "SampleFilter.h"
+#include "ShmStateWriter.h"
+#include "TrajectoryPlayer.h"
+#include "RemoteNodeTable.h"
+#include "PnpAllocationTable.h"
 
 /**************************************************************************************
  * NAMESPACE
@@ -51,7 +64,8 @@ public:
 
 
 private:
-  std::unique_ptr<CanManager> _can_mgr;
+  std::vector<std::unique_ptr<Transport>> _transport;
+  void init_transport();
 
   static size_t constexpr CYPHAL_O1HEAP_SIZE = (cyphal::Node::DEFAULT_O1HEAP_SIZE * 16);
   static size_t constexpr CYPHAL_TX_QUEUE_SIZE = 256;
@@ -60,6 +74,16 @@ private:
   cyphal::Node _node_hdl;
   std::mutex _node_mtx;
 
+  /* Ports 4001 and 5002 are served by a node handle of their own
+   * (sharing node id and transports) without any subscriptions, so
+   * that the trajectory playback thread can transmit setpoints right
+   * away without running the RX processing of _node_hdl.
+   */
+  cyphal::Node::Heap<cyphal::Node::DEFAULT_O1HEAP_SIZE> _setpoint_node_heap;
+  cyphal::Node _setpoint_node_hdl;
+  std::mutex _setpoint_node_mtx;
+  void transmit_setpoints();
+
   std::chrono::steady_clock::time_point const _node_start;
 
   heartbeat::Publisher::SharedPtr _heartbeat_pub;
@@ -73,6 +97,41 @@ private:
   cyphal::NodeInfo _cyphal_node_info;
   void init_cyphal_node_info();
 
+  static CanardPortID constexpr CYPHAL_TIME_SYNC_PORT_ID = 7168U;
+  bool _cyphal_time_sync_master_enable;
+  cyphal::Publisher<uavcan::time::Synchronization_1_0> _cyphal_time_sync_pub;
+  std::atomic<CanardMicrosecond> _cyphal_time_sync_tx_timestamp_usec;
+  std::chrono::steady_clock::time_point _prev_time_sync_timepoint;
+  static std::chrono::milliseconds constexpr CYPHAL_TIME_SYNC_PERIOD{1000};
+  void init_cyphal_time_sync();
+
+  cyphal::Subscription _cyphal_heartbeat_sub;
+  std::unique_ptr<RemoteNodeTable> _remote_node_table;
+  rclcpp::Publisher<diagnostic_msgs::msg::DiagnosticArray>::SharedPtr _remote_node_table_ros_pub;
+  std::chrono::steady_clock::time_point _prev_remote_node_table_timepoint;
+  static std::chrono::milliseconds constexpr REMOTE_NODE_TABLE_PUBLISH_PERIOD{1000};
+  void init_cyphal_remote_node_table();
+  void on_cyphal_heartbeat(uavcan::node::Heartbeat_1_0 const & msg, CanardNodeID const remote_node_id);
+  void publish_remote_node_table();
+
+  cyphal::Subscription _cyphal_pnp_sub;
+  cyphal::Publisher<uavcan::pnp::NodeIDAllocationData_1_0> _cyphal_pnp_pub;
+  std::unique_ptr<PnpAllocationTable> _pnp_allocation_table;
+  void init_cyphal_pnp_allocator();
+
+  bool transmit(CanardFrame const & frame);
+  void on_frame_received(CanardFrame const & frame, CanardMicrosecond const timestamp_usec);
+  void on_frame_transmitted(CanardFrame const & frame, CanardMicrosecond const timestamp_usec);
+  static std::optional<CanardPortID> toSubjectId(CanardFrame const & frame);
+
+  std::unique_ptr<ShmStateWriter> _shm_state;
+  void init_shm_state();
+
+  std::map<CanardPortID, SampleFilter> _cyphal_to_ros_filter;
+  std::map<CanardPortID, CanardMicrosecond> _cyphal_to_ros_rx_timestamp_usec;
+  void init_cyphal_to_ros_channel(CanardPortID const port_id, std::string const & ros_topic, SampleFilter::OnPublishFunc on_publish);
+  void on_cyphal_to_ros_sample(CanardPortID const port_id, double const value);
+
   std::map<CanardPortID, rclcpp::Publisher<std_msgs::msg::Float32>::SharedPtr> _angle_actual_ros_pub;
   std::map<CanardPortID, cyphal::Subscription> _angle_actual_cyphal_sub;
   void init_cyphal_to_ros_angle_actual();
@@ -109,6 +168,21 @@ private:
   cyphal::Publisher<reg::udral::service::actuator::common::sp::Scalar_0_1> _pump_rpm_setpoint_cyphal_pub;
   void init_ros_to_cyphal_pump_setpoint();
 
+  rclcpp::Subscription<trajectory_msgs::msg::JointTrajectory>::SharedPtr _trajectory_ros_sub;
+  std::unique_ptr<TrajectoryPlayer> _trajectory_player;
+  std::vector<std::string> _trajectory_joint_names;
+  std::vector<size_t> _trajectory_servo_value_idx;
+  std::optional<size_t> _trajectory_pump_value_idx;
+  /* Incremented (under _setpoint_node_mtx) whenever the joint layout
+   * changes or the playback is cancelled, setpoints sampled from points
+   * of a previous generation are discarded.
+   */
+  uint64_t _trajectory_generation;
+  void init_ros_to_cyphal_trajectory();
+  void on_trajectory(trajectory_msgs::msg::JointTrajectory const & msg);
+  void on_trajectory_setpoint(std::vector<double> const & values, uint64_t const generation);
+  void cancel_trajectory();
+
   CanardMicrosecond micros();
 
   static std::chrono::milliseconds constexpr IO_LOOP_RATE{1};
@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+#ifndef L3XZ_ROS_CYPHAL_BRIDGE_PNPALLOCATIONTABLE_H
+#define L3XZ_ROS_CYPHAL_BRIDGE_PNPALLOCATIONTABLE_H
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <map>
+#include <set>
+#include <string>
+#include <cstdint>
+#include <optional>
+
+#include <rclcpp/rclcpp.hpp>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Persistent mapping of the unique id hash of a Cyphal node
+ * (as sent in uavcan.pnp.NodeIDAllocationData) to the node id
+ * allocated to it, so that a node obtains the same id again
+ * after a restart of either the node or the bridge.
+ */
+class PnpAllocationTable
+{
+public:
+  PnpAllocationTable(rclcpp::Logger const logger,
+                     std::string const & file_name,
+                     uint8_t const node_id_min,
+                     uint8_t const node_id_max);
+
+
+  /* Returns the node id already allocated to unique_id_hash, unless
+   * it is contained in reserved_node_ids (i.e. the bridge's own node
+   * id) or out of range. Being contained in online_node_ids does not
+   * count, as a node restarting quickly is still considered online
+   * with the very node id it is asking for again. Otherwise the
+   * highest node id which is neither allocated, reserved nor online
+   * is allocated. Returns nullopt if the range of allocatable node ids
+   * is exhausted.
+   */
+  std::optional<uint8_t> allocate(uint64_t const unique_id_hash,
+                                  std::set<uint8_t> const & reserved_node_ids,
+                                  std::set<uint8_t> const & online_node_ids);
+
+  size_t size() const { return _table.size(); }
+
+
+private:
+  rclcpp::Logger const _logger;
+  std::string const FILE_NAME;
+  uint8_t const NODE_ID_MIN, NODE_ID_MAX;
+  std::map<uint64_t, uint8_t> _table;
+
+  void load();
+  void store();
+};
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */
+
+#endif /* L3XZ_ROS_CYPHAL_BRIDGE_PNPALLOCATIONTABLE_H */
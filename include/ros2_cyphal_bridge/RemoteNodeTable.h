@@ -0,0 +1,79 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+#ifndef L3XZ_ROS_CYPHAL_BRIDGE_REMOTENODETABLE_H
+#define L3XZ_ROS_CYPHAL_BRIDGE_REMOTENODETABLE_H
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <map>
+#include <set>
+#include <chrono>
+#include <vector>
+#include <cstdint>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Keeps track of all remote Cyphal nodes by means of their
+ * uavcan.node.Heartbeat, a node is considered offline if no
+ * heartbeat has been received for longer than the offline timeout.
+ */
+class RemoteNodeTable
+{
+public:
+  struct Entry
+  {
+    uint8_t health;
+    uint8_t mode;
+    uint32_t uptime;
+    uint8_t vendor_specific_status_code;
+    std::chrono::steady_clock::time_point last_seen;
+    std::chrono::system_clock::time_point last_seen_wall;
+    bool is_online;
+  };
+
+  RemoteNodeTable(std::chrono::milliseconds const offline_timeout);
+
+
+  /* Returns true if the node has been (re-)discovered. */
+  bool update(uint8_t const node_id,
+              uint8_t const health,
+              uint8_t const mode,
+              uint32_t const uptime,
+              uint8_t const vendor_specific_status_code,
+              std::chrono::steady_clock::time_point const now);
+
+  /* Returns the ids of all nodes which went offline since the last call. */
+  std::vector<uint8_t> checkOffline(std::chrono::steady_clock::time_point const now);
+
+  std::set<uint8_t> online() const;
+
+  std::map<uint8_t, Entry> const & entries() const { return _table; }
+
+
+private:
+  std::chrono::milliseconds const OFFLINE_TIMEOUT;
+  std::map<uint8_t, Entry> _table;
+};
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */
+
+#endif /* L3XZ_ROS_CYPHAL_BRIDGE_REMOTENODETABLE_H */
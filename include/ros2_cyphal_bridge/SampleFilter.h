@@ -0,0 +1,90 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+#ifndef L3XZ_ROS_CYPHAL_BRIDGE_SAMPLEFILTER_H
+#define L3XZ_ROS_CYPHAL_BRIDGE_SAMPLEFILTER_H
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <chrono>
+#include <string>
+#include <optional>
+#include <functional>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Sits between a Cyphal subscription and its ROS publisher and
+ * decides which samples are actually worth publishing: samples
+ * are collected over a window of 1/rate_hz, the window is reduced
+ * to a single value (latest/mean/min/max) and that value is only
+ * published if it leaves the deadband around the last published
+ * value. As long as samples keep arriving the last value is
+ * re-published every keepalive period so that a silent sensor
+ * can be told apart from a dead one.
+ */
+class SampleFilter
+{
+public:
+  enum class Window { Latest, Mean, Min, Max };
+
+  struct Config
+  {
+    bool enable;
+    double deadband_abs;
+    double deadband_rel;
+    double rate_hz;
+    Window window;
+    std::chrono::milliseconds keepalive;
+  };
+
+  typedef std::function<void(double const)> OnPublishFunc;
+
+  SampleFilter(Config const & cfg, OnPublishFunc on_publish);
+
+
+  void update(double const sample, std::chrono::steady_clock::time_point const now);
+  void spin(std::chrono::steady_clock::time_point const now);
+
+
+  static std::optional<Window> toWindow(std::string const & window_str);
+
+
+private:
+  Config const _cfg;
+  std::chrono::steady_clock::duration const _window_period;
+  OnPublishFunc _on_publish;
+
+  size_t _window_cnt;
+  double _window_sum, _window_min, _window_max, _window_latest;
+  std::chrono::steady_clock::time_point _window_start;
+
+  std::optional<double> _prev_published;
+  std::chrono::steady_clock::time_point _prev_publish_timepoint;
+
+  void close_window(std::chrono::steady_clock::time_point const now);
+  double reduce_window() const;
+  bool is_outside_deadband(double const value) const;
+  void publish(double const value, std::chrono::steady_clock::time_point const now);
+};
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */
+
+#endif /* L3XZ_ROS_CYPHAL_BRIDGE_SAMPLEFILTER_H */
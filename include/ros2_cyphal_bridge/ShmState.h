@@ -0,0 +1,83 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+#ifndef L3XZ_ROS_CYPHAL_BRIDGE_SHMSTATE_H
+#define L3XZ_ROS_CYPHAL_BRIDGE_SHMSTATE_H
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz::shm
+{
+
+/**************************************************************************************
+ * CONSTANTS
+ **************************************************************************************/
+
+static char     constexpr DEFAULT_NAME[]   = "/l3xz_ros2_cyphal_bridge_state";
+static uint32_t constexpr MAGIC            = 0x4C33585A; /* "L3XZ" */
+static uint32_t constexpr VERSION          = 1;
+static size_t   constexpr MAX_ENTRIES      = 64;
+static size_t   constexpr MAX_TOPIC_LENGTH = 64;
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "shared memory seqlock requires lock-free 64-bit atomics");
+
+/**************************************************************************************
+ * TYPEDEF
+ **************************************************************************************/
+
+/* Memory layout of the state segment shared between the bridge
+ * (single writer) and any number of readers. The values of all
+ * entries are protected by a single sequence counter, which is odd
+ * while the writer is modifying them. Values are stored as the bit
+ * pattern of a double, timestamps as CLOCK_REALTIME nanoseconds
+ * (the kernel RX timestamp of the frame if available).
+ * port_id and topic of an entry are written once before num_entries
+ * is incremented and never change afterwards.
+ */
+struct Entry
+{
+  std::atomic<uint64_t> port_id;
+  std::atomic<uint64_t> value;
+  std::atomic<uint64_t> timestamp_ns;
+  std::atomic<uint64_t> sample_cnt;
+  char topic[MAX_TOPIC_LENGTH];
+};
+
+struct Segment
+{
+  std::atomic<uint32_t> magic;
+  std::atomic<uint32_t> version;
+  std::atomic<uint64_t> seq;
+  std::atomic<uint64_t> num_entries;
+  Entry entry[MAX_ENTRIES];
+};
+
+/* Consistent copy of a single entry as handed out to readers. */
+struct Sample
+{
+  uint16_t port_id;
+  double value;
+  uint64_t timestamp_ns;
+  uint64_t sample_cnt;
+};
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz::shm */
+
+#endif /* L3XZ_ROS_CYPHAL_BRIDGE_SHMSTATE_H */
@@ -0,0 +1,205 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+#ifndef L3XZ_ROS_CYPHAL_BRIDGE_SHMSTATEREADER_H
+#define L3XZ_ROS_CYPHAL_BRIDGE_SHMSTATEREADER_H
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <array>
+#include <string>
+#include <cstring>
+#include <optional>
+#include <stdexcept>
+
+#include "ShmState.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz::shm
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Header-only, lock-free and syscall-free (after construction)
+ * access to the state segment written by ros2_cyphal_bridge.
+ *
+ *   l3xz::shm::Reader reader;
+ *   size_t const femur_idx = reader.find(1001).value();
+ *   std::optional<l3xz::shm::Sample> const femur = reader.try_read(femur_idx);
+ */
+class Reader
+{
+public:
+  typedef std::array<Sample, MAX_ENTRIES> Snapshot;
+
+  explicit Reader(std::string const & name = DEFAULT_NAME)
+  : _segment{nullptr}
+  {
+    int const fd = shm_open(name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+      throw std::runtime_error("Reader: 'shm_open(\"" + name + "\")' failed with error " + strerror(errno));
+
+    void * addr = mmap(nullptr, sizeof(Segment), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+
+    if (addr == MAP_FAILED)
+      throw std::runtime_error("Reader: 'mmap' failed with error " + std::string(strerror(errno)));
+
+    _segment = static_cast<Segment const *>(addr);
+
+    if (_segment->magic.load(std::memory_order_acquire) != MAGIC ||
+        _segment->version.load(std::memory_order_relaxed) != VERSION)
+    {
+      munmap(const_cast<Segment *>(_segment), sizeof(Segment));
+      throw std::runtime_error("Reader: shared memory segment \"" + name + "\" is invalid or of an incompatible version");
+    }
+  }
+
+  ~Reader()
+  {
+    munmap(const_cast<Segment *>(_segment), sizeof(Segment));
+  }
+
+  Reader(Reader const &) = delete;
+  Reader & operator = (Reader const &) = delete;
+
+
+  /* Returns false once the bridge has shut down. */
+  bool isValid() const
+  {
+    return _segment->magic.load(std::memory_order_acquire) == MAGIC;
+  }
+
+  size_t size() const
+  {
+    return _segment->num_entries.load(std::memory_order_acquire);
+  }
+
+  /* Look up the entry index of a Cyphal port, meant to be
+   * called once during initialization of the reader.
+   */
+  std::optional<size_t> find(uint16_t const port_id) const
+  {
+    for (size_t idx = 0; idx < size(); idx++)
+      if (_segment->entry[idx].port_id.load(std::memory_order_relaxed) == port_id)
+        return idx;
+    return std::nullopt;
+  }
+
+  char const * topic(size_t const idx) const
+  {
+    return _segment->entry[idx].topic;
+  }
+
+  /* A write only takes a few ten nanoseconds, so a read which
+   * overlapped with one succeeds after very few retries, while a
+   * segment left inconsistent is detected within microseconds.
+   */
+  static size_t constexpr DEFAULT_MAX_READ_ATTEMPTS = 1000;
+
+  /* Bounded read of a single entry, returns nullopt if no consistent
+   * copy could be obtained within max_attempts (i.e. the bridge died
+   * in the middle of an update). Use this within real-time readers.
+   */
+  std::optional<Sample> try_read(size_t const idx, size_t const max_attempts = DEFAULT_MAX_READ_ATTEMPTS) const
+  {
+    Sample sample{};
+    for (size_t attempt = 0; attempt < max_attempts; attempt++)
+      if (try_load([&]() { sample = load(idx); }))
+        return sample;
+    return std::nullopt;
+  }
+
+  /* Bounded consistent copy of all entries, returns the number of
+   * valid entries or nullopt, see try_read(idx, max_attempts).
+   */
+  std::optional<size_t> try_read(Snapshot & snapshot, size_t const max_attempts = DEFAULT_MAX_READ_ATTEMPTS) const
+  {
+    size_t const num_entries = size();
+    for (size_t attempt = 0; attempt < max_attempts; attempt++)
+    {
+      bool const is_consistent = try_load([&]()
+      {
+        for (size_t idx = 0; idx < num_entries; idx++)
+          snapshot[idx] = load(idx);
+      });
+
+      if (is_consistent)
+        return num_entries;
+    }
+    return std::nullopt;
+  }
+
+  /* Unbounded variants of try_read, they spin for as long as a write
+   * is in progress and hang forever if the bridge died in the middle
+   * of an update. Not suitable for hard real-time readers.
+   */
+  Sample read(size_t const idx) const
+  {
+    std::optional<Sample> sample;
+    while (!(sample = try_read(idx)).has_value()) { }
+    return sample.value();
+  }
+
+  size_t read(Snapshot & snapshot) const
+  {
+    std::optional<size_t> num_entries;
+    while (!(num_entries = try_read(snapshot)).has_value()) { }
+    return num_entries.value();
+  }
+
+
+private:
+  Segment const * _segment;
+
+  /* Single read attempt according to the seqlock protocol, returns
+   * false if the writer has been modifying the values meanwhile.
+   */
+  template <typename LoadFunc>
+  bool try_load(LoadFunc load_func) const
+  {
+    uint64_t const seq_begin = _segment->seq.load(std::memory_order_acquire);
+    if (seq_begin & 1)
+      return false;
+
+    load_func();
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return (_segment->seq.load(std::memory_order_relaxed) == seq_begin);
+  }
+
+  Sample load(size_t const idx) const
+  {
+    Entry const & entry = _segment->entry[idx];
+
+    Sample sample;
+    uint64_t const value_bits = entry.value.load(std::memory_order_relaxed);
+    sample.port_id      = static_cast<uint16_t>(entry.port_id.load(std::memory_order_relaxed));
+    memcpy(&sample.value, &value_bits, sizeof(sample.value));
+    sample.timestamp_ns = entry.timestamp_ns.load(std::memory_order_relaxed);
+    sample.sample_cnt   = entry.sample_cnt.load(std::memory_order_relaxed);
+    return sample;
+  }
+};
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz::shm */
+
+#endif /* L3XZ_ROS_CYPHAL_BRIDGE_SHMSTATEREADER_H */
@@ -0,0 +1,61 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+#ifndef L3XZ_ROS_CYPHAL_BRIDGE_SHMSTATEWRITER_H
+#define L3XZ_ROS_CYPHAL_BRIDGE_SHMSTATEWRITER_H
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <map>
+#include <string>
+#include <cstdint>
+
+#include <rclcpp/rclcpp.hpp>
+
+#include "ShmState.h"
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Creates the POSIX shared memory state segment and publishes
+ * the latest value of each registered Cyphal port into it.
+ * There must only be a single writer per segment.
+ */
+class ShmStateWriter
+{
+public:
+  ShmStateWriter(rclcpp::Logger const logger, std::string const & name);
+  ~ShmStateWriter();
+
+
+  void add(uint16_t const port_id, std::string const & topic);
+  void update(uint16_t const port_id, double const value, uint64_t const timestamp_ns);
+
+
+private:
+  rclcpp::Logger const _logger;
+  std::string const SHM_NAME;
+  shm::Segment * _segment;
+  std::map<uint16_t, size_t> _port_id_to_entry;
+};
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */
+
+#endif /* L3XZ_ROS_CYPHAL_BRIDGE_SHMSTATEWRITER_H */
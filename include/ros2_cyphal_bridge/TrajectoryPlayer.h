@@ -0,0 +1,112 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+#ifndef L3XZ_ROS_CYPHAL_BRIDGE_TRAJECTORYPLAYER_H
+#define L3XZ_ROS_CYPHAL_BRIDGE_TRAJECTORYPLAYER_H
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <deque>
+#include <mutex>
+#include <chrono>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <functional>
+
+#include <rclcpp/rclcpp.hpp>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Plays out a buffer of time-stamped setpoints from a dedicated
+ * thread which wakes up at absolute (CLOCK_MONOTONIC) deadlines,
+ * so that the cadence of the setpoints is independent from the
+ * scheduling of the ROS executor.
+ */
+class TrajectoryPlayer
+{
+public:
+  enum class Interpolation { Step, Linear };
+  /* Hold: keep sending the last setpoint once the buffer runs dry.
+   * Stop: send the last setpoint once, then stop sending.
+   */
+  enum class UnderrunPolicy { Hold, Stop };
+
+  /* The generation is handed back together with every setpoint
+   * sampled from this point, allowing the caller to discard
+   * setpoints whose values no longer match its current layout.
+   */
+  struct Point
+  {
+    std::chrono::steady_clock::time_point time;
+    std::vector<double> values;
+    uint64_t generation;
+  };
+
+  typedef std::function<void(std::vector<double> const &, uint64_t const)> OnSetpointFunc;
+
+  TrajectoryPlayer(rclcpp::Logger const logger,
+                   std::chrono::microseconds const period,
+                   Interpolation const interpolation,
+                   UnderrunPolicy const underrun_policy,
+                   int const thread_priority,
+                   OnSetpointFunc on_setpoint);
+  ~TrajectoryPlayer();
+
+
+  /* Replaces all buffered points at or after the first new point,
+   * all points are expected to be sorted by time. Setting replace_all
+   * discards all buffered points, i.e. because the layout of the
+   * values has changed.
+   */
+  void load(std::vector<Point> const & points, bool const replace_all);
+  void clear();
+
+
+  static std::optional<Interpolation> toInterpolation(std::string const & interpolation_str);
+  static std::optional<UnderrunPolicy> toUnderrunPolicy(std::string const & underrun_policy_str);
+
+
+private:
+  rclcpp::Logger const _logger;
+  std::chrono::microseconds const PERIOD;
+  Interpolation const INTERPOLATION;
+  UnderrunPolicy const UNDERRUN_POLICY;
+  OnSetpointFunc _on_setpoint;
+  rclcpp::Clock _clock;
+
+  std::mutex _points_mtx;
+  std::deque<Point> _points;
+  bool _is_underrun;
+
+  std::atomic<bool> _thread_active;
+  std::thread _thread;
+  void thread_func(int const thread_priority);
+
+  std::optional<Point> sample(std::chrono::steady_clock::time_point const now);
+};
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */
+
+#endif /* L3XZ_ROS_CYPHAL_BRIDGE_TRAJECTORYPLAYER_H */
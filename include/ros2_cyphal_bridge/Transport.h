@@ -0,0 +1,67 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+#ifndef L3XZ_ROS_CYPHAL_BRIDGE_TRANSPORT_H
+#define L3XZ_ROS_CYPHAL_BRIDGE_TRANSPORT_H
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <functional>
+
+#include <canard.h>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CLASS DECLARATION
+ **************************************************************************************/
+
+/* Common interface of all backends moving Cyphal frames between
+ * the cyphal::Node and the outside world. Both callbacks are
+ * provided with the kernel timestamp (CLOCK_REALTIME) of the frame,
+ * on_frame_transmitted is invoked for each looped-back frame and
+ * its timestamp denotes the moment the frame has actually been sent.
+ *
+ * Each transport keeps its own queue of outgoing frames, so that a
+ * frame which can not be sent right away on one transport is retried
+ * there without affecting (or being duplicated on) any other one.
+ * Both transmit() and flush() never block and may be called from
+ * different threads.
+ */
+class Transport
+{
+public:
+  typedef std::function<void(CanardFrame const &, CanardMicrosecond const)> OnFrameReceivedFunc;
+  typedef std::function<void(CanardFrame const &, CanardMicrosecond const)> OnFrameTransmittedFunc;
+
+  virtual ~Transport() { }
+
+
+  /* Queues a copy of the frame, returns false if the
+   * frame had to be dropped because the queue is full.
+   */
+  virtual bool transmit(CanardFrame const & frame) = 0;
+  /* Sends out as many queued frames as possible, frames
+   * which can not be sent right now stay queued until the
+   * next invocation.
+   */
+  virtual void flush() = 0;
+};
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */
+
+#endif /* L3XZ_ROS_CYPHAL_BRIDGE_TRANSPORT_H */
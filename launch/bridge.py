@@ -13,6 +13,29 @@ def generate_launch_description():
       parameters=[
         {'can_iface' : 'can0'},
         {'can_node_id' : 100},
+        {'shm_state_enable' : True},
+        {'shm_state_name' : '/l3xz_ros2_cyphal_bridge_state'},
+        {'remote_node_offline_timeout_ms' : 1500},
+        {'pnp_enable' : True},
+        {'pnp_allocation_table_file' : '/var/tmp/ros2_cyphal_bridge_pnp_allocation_table.txt'},
+        {'pnp_node_id_min' : 1},
+        {'pnp_node_id_max' : 125},
+        {'trajectory_period_us' : 10000},
+        {'trajectory_interpolation' : 'linear'},
+        {'trajectory_underrun_policy' : 'hold'},
+        {'trajectory_thread_priority' : 0},
+        {'pressure_0.filter.enable' : True},
+        {'pressure_0.filter.deadband_abs' : 100.0},
+        {'pressure_0.filter.rate_hz' : 10.0},
+        {'pressure_0.filter.window' : 'mean'},
+        {'pressure_0.filter.keepalive_ms' : 1000},
+        {'pressure_1.filter.enable' : True},
+        {'pressure_1.filter.deadband_abs' : 100.0},
+        {'pressure_1.filter.rate_hz' : 10.0},
+        {'pressure_1.filter.window' : 'mean'},
+        {'pressure_1.filter.keepalive_ms' : 1000},
+        {'radiation.filter.enable' : True},
+        {'radiation.filter.keepalive_ms' : 1000},
       ]
     )
   ])
@@ -12,6 +12,9 @@
 
 #include <unistd.h>
 
+#include <cstring>
+#include <algorithm>
+
 /**************************************************************************************
  * NAMESPACE
  **************************************************************************************/
@@ -23,12 +26,22 @@ namespace l3xz
  * CTOR/DTOR
  **************************************************************************************/
 
-CanManager::CanManager(rclcpp::Logger const logger, std::string const & iface_name, OnCanFrameReceivedFunc on_can_frame_received)
+CanManager::CanManager(rclcpp::Logger const logger,
+                       std::string const & iface_name,
+                       OnFrameReceivedFunc on_can_frame_received,
+                       OnFrameTransmittedFunc on_can_frame_transmitted)
 : _logger{logger}
 , IFACE_NAME{iface_name}
 , IS_CAN_FD{false}
 , _socket_can_fd{socketcanOpen(IFACE_NAME.c_str(), IS_CAN_FD)}
 , _on_can_frame_received{on_can_frame_received}
+, _on_can_frame_transmitted{on_can_frame_transmitted}
+, _tx_mtx{}
+, _tx_queue{}
+, _tx_drop_cnt_queue_full{0}
+, _tx_drop_cnt_timeout{0}
+, _tx_last_error{0}
+, _prev_tx_drop_log_timepoint{std::chrono::steady_clock::now()}
 , _rx_thread_active{false}
 , _rx_thread{[this]() { this->rx_thread_func(); }}
 {
@@ -50,27 +63,88 @@ CanManager::~CanManager()
 
 bool CanManager::transmit(CanardFrame const & frame)
 {
-  static CanardMicrosecond constexpr CAN_TRANSMIT_TIMEOUT_us = 1000*1000UL; /* 1 second. */
-
-  int16_t const rc = socketcanPush(_socket_can_fd, &frame, CAN_TRANSMIT_TIMEOUT_us);
+  std::lock_guard<std::mutex> lock(_tx_mtx);
 
-  if (rc < 0) {
-    RCLCPP_ERROR(_logger, "'socketcanPush' failed with error %s.", strerror(abs(rc)));
+  if (_tx_queue.size() >= TX_QUEUE_SIZE) {
+    _tx_drop_cnt_queue_full++;
     return false;
   }
 
-  if (rc == 0) {
-    RCLCPP_ERROR(_logger, "'socketcanPush' failed with error 'timeout'.");
-    return false;
-  }
+  TxFrame tx_frame;
+  tx_frame.extended_can_id = frame.extended_can_id;
+  tx_frame.payload_size = std::min(frame.payload_size, tx_frame.payload.size());
+  memcpy(tx_frame.payload.data(), frame.payload, tx_frame.payload_size);
+  tx_frame.deadline = std::chrono::steady_clock::now() + TX_TIMEOUT;
 
+  _tx_queue.push_back(tx_frame);
   return true;
 }
 
+void CanManager::flush()
+{
+  std::lock_guard<std::mutex> lock(_tx_mtx);
+
+  auto const now = std::chrono::steady_clock::now();
+
+  while (!_tx_queue.empty())
+  {
+    TxFrame const & tx_frame = _tx_queue.front();
+
+    if (now > tx_frame.deadline) {
+      _tx_drop_cnt_timeout++;
+      _tx_queue.pop_front();
+      continue;
+    }
+
+    CanardFrame frame;
+    frame.extended_can_id = tx_frame.extended_can_id;
+    frame.payload_size    = tx_frame.payload_size;
+    frame.payload         = tx_frame.payload.data();
+
+    /* Never block, a frame which can not be enqueued with the
+     * kernel right now (i.e. the socket buffer is full or the
+     * interface is down) is retried upon the next flush.
+     */
+    int16_t const rc = socketcanPush(_socket_can_fd, &frame, 0);
+
+    if (rc < 0) {
+      _tx_last_error = rc;
+      break;
+    }
+
+    if (rc == 0)
+      break;
+
+    _tx_queue.pop_front();
+  }
+
+  log_tx_drops(now);
+}
+
 /**************************************************************************************
  * PRIVATE MEMBER FUNCTIONS
  **************************************************************************************/
 
+void CanManager::log_tx_drops(std::chrono::steady_clock::time_point const now)
+{
+  if ((now - _prev_tx_drop_log_timepoint) < TX_DROP_LOG_PERIOD)
+    return;
+
+  if (_tx_drop_cnt_queue_full > 0 || _tx_drop_cnt_timeout > 0)
+    RCLCPP_ERROR(_logger,
+                 "Dropped %zu CAN frame(s) due to a full transmit queue and %zu CAN frame(s) not sent within %ld ms during the last %ld ms, last 'socketcanPush' error: %s.",
+                 _tx_drop_cnt_queue_full,
+                 _tx_drop_cnt_timeout,
+                 TX_TIMEOUT.count(),
+                 std::chrono::duration_cast<std::chrono::milliseconds>(now - _prev_tx_drop_log_timepoint).count(),
+                 (_tx_last_error < 0) ? strerror(abs(_tx_last_error)) : "none (socket buffer full)");
+
+  _tx_drop_cnt_queue_full = 0;
+  _tx_drop_cnt_timeout = 0;
+  _tx_last_error = 0;
+  _prev_tx_drop_log_timepoint = now;
+}
+
 void CanManager::rx_thread_func()
 {
   _rx_thread_active = true;
@@ -78,12 +152,14 @@ void CanManager::rx_thread_func()
   while (_rx_thread_active)
   {
     CanardFrame rx_frame;
+    CanardMicrosecond rx_timestamp_usec = 0;
+    bool is_loopback = false;
     uint8_t payload_buffer[CANARD_MTU_CAN_CLASSIC] = {0};
 
-    int16_t const rc_blocking = socketcanPop(_socket_can_fd, &rx_frame, sizeof(payload_buffer), payload_buffer, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC, nullptr);
+    int16_t const rc_blocking = socketcanPop(_socket_can_fd, &rx_frame, &rx_timestamp_usec, sizeof(payload_buffer), payload_buffer, CANARD_DEFAULT_TRANSFER_ID_TIMEOUT_USEC, &is_loopback);
 
     if (rc_blocking > 0)
-      _on_can_frame_received(rx_frame);
+      on_frame(rx_frame, rx_timestamp_usec, is_loopback);
     else if (rc_blocking == 0)
       RCLCPP_DEBUG(_logger, "'socketcanPop' receive time-out (this is expected if no CAN messages are being received).");
     else
@@ -122,10 +198,10 @@ void CanManager::rx_thread_func()
          * print an error and attempt a delayed re-connect, otherwise
          * leave this loop.
          */
-        int16_t const rc_non_blocking = socketcanPop(_socket_can_fd, &rx_frame, sizeof(payload_buffer), payload_buffer, 0, nullptr);
+        int16_t const rc_non_blocking = socketcanPop(_socket_can_fd, &rx_frame, &rx_timestamp_usec, sizeof(payload_buffer), payload_buffer, 0, &is_loopback);
         if (rc_non_blocking > 0) /* Frame received. */
         {
-          _on_can_frame_received(rx_frame);
+          on_frame(rx_frame, rx_timestamp_usec, is_loopback);
           break;
         }
         else if (rc_non_blocking == 0) /* Timeout. */
@@ -150,6 +226,14 @@ void CanManager::rx_thread_func()
   close(_socket_can_fd);
 }
 
+void CanManager::on_frame(CanardFrame const & frame, CanardMicrosecond const timestamp_usec, bool const is_loopback)
+{
+  if (is_loopback)
+    _on_can_frame_transmitted(frame, timestamp_usec);
+  else
+    _on_can_frame_received(frame, timestamp_usec);
+}
+
 /**************************************************************************************
  * NAMESPACE
  **************************************************************************************/
@@ -10,6 +10,9 @@
 
 #include <ros2_cyphal_bridge/Node.h>
 
+#include <cmath>
+#include <algorithm>
+
 /**************************************************************************************
  * NAMESPACE
  **************************************************************************************/
@@ -27,18 +30,38 @@ Node::Node()
 , _node_hdl{_node_heap.data(),
             _node_heap.size(),
             [this] () { return micros(); },
-            [this] (CanardFrame const & frame) { return _can_mgr->transmit(frame); },
+            [this] (CanardFrame const & frame) { return transmit(frame); },
             cyphal::Node::DEFAULT_NODE_ID,
             CYPHAL_TX_QUEUE_SIZE,
             CYPHAL_RX_QUEUE_SIZE,
             cyphal::Node::DEFAULT_MTU_SIZE}
 , _node_mtx{}
+, _setpoint_node_heap{}
+, _setpoint_node_hdl{_setpoint_node_heap.data(),
+                     _setpoint_node_heap.size(),
+                     [this] () { return micros(); },
+                     [this] (CanardFrame const & frame) { return transmit(frame); },
+                     cyphal::Node::DEFAULT_NODE_ID,
+                     CYPHAL_TX_QUEUE_SIZE,
+                     CYPHAL_RX_QUEUE_SIZE,
+                     cyphal::Node::DEFAULT_MTU_SIZE}
+, _setpoint_node_mtx{}
 , _node_start{std::chrono::steady_clock::now()}
 , _prev_heartbeat_timepoint{std::chrono::steady_clock::now()}
+, _cyphal_time_sync_master_enable{true}
+, _cyphal_time_sync_tx_timestamp_usec{0}
+, _prev_time_sync_timepoint{std::chrono::steady_clock::now()}
+, _prev_remote_node_table_timepoint{std::chrono::steady_clock::now()}
+, _trajectory_generation{0}
 {
   init_heartbeat();
   init_cyphal_heartbeat();
   init_cyphal_node_info();
+  init_cyphal_time_sync();
+  init_cyphal_remote_node_table();
+  init_cyphal_pnp_allocator();
+
+  init_shm_state();
 
   init_cyphal_to_ros_angle_actual();
   init_cyphal_to_ros_tibia_endpoint_switch();
@@ -49,25 +72,9 @@ Node::Node()
   init_ros_to_cyphal_servo_pulse_width();
   init_ros_to_cyphal_pump_readiness();
   init_ros_to_cyphal_pump_setpoint();
+  init_ros_to_cyphal_trajectory();
 
-  declare_parameter("can_iface", "can0");
-  declare_parameter("can_node_id", 100);
-
-  RCLCPP_INFO(get_logger(),
-              "configuring CAN bus:\n\tDevice: %s\n\tNode Id: %ld",
-              get_parameter("can_iface").as_string().c_str(),
-              get_parameter("can_node_id").as_int());
-
-  _node_hdl.setNodeId(get_parameter("can_node_id").as_int());
-
-  _can_mgr = std::make_unique<CanManager>(
-    get_logger(),
-    get_parameter("can_iface").as_string(),
-    [this](CanardFrame const & frame)
-    {
-      std::lock_guard<std::mutex> lock(_node_mtx);
-      _node_hdl.onCanFrameReceived(frame);
-    });
+  init_transport();
 
   /* Configure periodic control loop function. */
   _io_loop_rate_monitor = loop_rate::Monitor::create
@@ -80,6 +87,12 @@ Node::Node()
 
 Node::~Node()
 {
+  /* Stop all threads calling back into this node before any
+   * member is destroyed, independent of the declaration order.
+   */
+  _trajectory_player.reset();
+  _transport.clear();
+
   RCLCPP_INFO(get_logger(), "%s shut down successfully.", get_name());
 }
 
@@ -87,6 +100,26 @@ Node::~Node()
  * PUBLIC MEMBER FUNCTIONS
  **************************************************************************************/
 
+void Node::init_transport()
+{
+  declare_parameter("can_iface", "can0");
+  declare_parameter("can_node_id", 100);
+
+  RCLCPP_INFO(get_logger(),
+              "configuring CAN bus:\n\tDevice: %s\n\tNode Id: %ld",
+              get_parameter("can_iface").as_string().c_str(),
+              get_parameter("can_node_id").as_int());
+
+  _node_hdl.setNodeId(get_parameter("can_node_id").as_int());
+  _setpoint_node_hdl.setNodeId(get_parameter("can_node_id").as_int());
+
+  _transport.push_back(std::make_unique<CanManager>(
+    get_logger(),
+    get_parameter("can_iface").as_string(),
+    [this](CanardFrame const & frame, CanardMicrosecond const timestamp_usec) { on_frame_received(frame, timestamp_usec); },
+    [this](CanardFrame const & frame, CanardMicrosecond const timestamp_usec) { on_frame_transmitted(frame, timestamp_usec); }));
+}
+
 void Node::init_heartbeat()
 {
   std::stringstream heartbeat_topic;
@@ -122,6 +155,89 @@ void Node::init_cyphal_node_info()
   );
 }
 
+void Node::init_cyphal_time_sync()
+{
+  declare_parameter("cyphal_time_sync_master", true);
+  _cyphal_time_sync_master_enable = get_parameter("cyphal_time_sync_master").as_bool();
+
+  _cyphal_time_sync_pub = _node_hdl.create_publisher<uavcan::time::Synchronization_1_0>(1*1000*1000UL /* = 1 sec in usecs. */);
+}
+
+void Node::init_cyphal_remote_node_table()
+{
+  declare_parameter("remote_node_offline_timeout_ms", 1500);
+
+  _remote_node_table = std::make_unique<RemoteNodeTable>(std::chrono::milliseconds(get_parameter("remote_node_offline_timeout_ms").as_int()));
+
+  std::stringstream remote_node_table_topic;
+  remote_node_table_topic << "/l3xz/" << get_name() << "/cyphal_node_table";
+
+  _remote_node_table_ros_pub = create_publisher<diagnostic_msgs::msg::DiagnosticArray>(remote_node_table_topic.str(), 10);
+
+  _cyphal_heartbeat_sub = _node_hdl.create_subscription<uavcan::node::Heartbeat_1_0>(
+    [this](uavcan::node::Heartbeat_1_0 const & msg, cyphal::TransferMetadata const & metadata)
+    {
+      on_cyphal_heartbeat(msg, metadata.remote_node_id);
+    });
+}
+
+void Node::init_cyphal_pnp_allocator()
+{
+  declare_parameter("pnp_enable", true);
+  declare_parameter("pnp_allocation_table_file", "/var/tmp/ros2_cyphal_bridge_pnp_allocation_table.txt");
+  declare_parameter("pnp_node_id_min", 1);
+  declare_parameter("pnp_node_id_max", 125);
+
+  if (!get_parameter("pnp_enable").as_bool())
+    return;
+
+  int64_t const node_id_min = get_parameter("pnp_node_id_min").as_int();
+  int64_t const node_id_max = get_parameter("pnp_node_id_max").as_int();
+  if (node_id_min < 0 || node_id_min > node_id_max || node_id_max > CANARD_NODE_ID_MAX)
+    throw std::runtime_error("Invalid PnP node id range [" + std::to_string(node_id_min) + ", " + std::to_string(node_id_max) + "], expected 0 <= \"pnp_node_id_min\" <= \"pnp_node_id_max\" <= " + std::to_string(CANARD_NODE_ID_MAX) + ".");
+
+  _pnp_allocation_table = std::make_unique<PnpAllocationTable>(
+    get_logger(),
+    get_parameter("pnp_allocation_table_file").as_string(),
+    static_cast<uint8_t>(node_id_min),
+    static_cast<uint8_t>(node_id_max));
+
+  _cyphal_pnp_pub = _node_hdl.create_publisher<uavcan::pnp::NodeIDAllocationData_1_0>(1*1000*1000UL /* = 1 sec in usecs. */);
+
+  _cyphal_pnp_sub = _node_hdl.create_subscription<uavcan::pnp::NodeIDAllocationData_1_0>(
+    [this](uavcan::pnp::NodeIDAllocationData_1_0 const & msg)
+    {
+      /* Messages carrying a node id are responses of
+       * (possibly other) allocators, only serve requests.
+       */
+      if (!msg.allocated_node_id.empty())
+        return;
+
+      std::set<uint8_t> const reserved_node_ids = {static_cast<uint8_t>(get_parameter("can_node_id").as_int())};
+
+      auto const node_id = _pnp_allocation_table->allocate(msg.unique_id_hash, reserved_node_ids, _remote_node_table->online());
+      if (!node_id.has_value()) {
+        RCLCPP_ERROR(get_logger(), "PnP: no free node id left for unique id hash %012lx", static_cast<uint64_t>(msg.unique_id_hash));
+        return;
+      }
+
+      uavcan::pnp::NodeIDAllocationData_1_0 response;
+      response.unique_id_hash = msg.unique_id_hash;
+      uavcan::node::ID_1_0 allocated_node_id;
+      allocated_node_id.value = node_id.value();
+      response.allocated_node_id.push_back(allocated_node_id);
+      _cyphal_pnp_pub->publish(response);
+
+      RCLCPP_INFO(get_logger(), "PnP: allocated node id %d to unique id hash %012lx", node_id.value(), static_cast<uint64_t>(msg.unique_id_hash));
+    });
+
+  RCLCPP_INFO(get_logger(),
+              "PnP node id allocator serving node ids [%ld, %ld], %zu allocation(s) known",
+              node_id_min,
+              node_id_max,
+              _pnp_allocation_table->size());
+}
+
 void Node::io_loop()
 {
   _io_loop_rate_monitor->update();
@@ -141,8 +257,14 @@ void Node::io_loop()
 
   _node_hdl.spinSome();
 
+  for (auto & transport : _transport)
+    transport->flush();
+
   auto const now = std::chrono::steady_clock::now();
 
+  for (auto & [port_id, filter] : _cyphal_to_ros_filter)
+    filter.spin(now);
+
   if ((now - _prev_heartbeat_timepoint) > CYPHAL_HEARTBEAT_PERIOD)
   {
     uavcan::node::Heartbeat_1_0 msg;
@@ -156,6 +278,32 @@ void Node::io_loop()
 
     _prev_heartbeat_timepoint = now;
   }
+
+  if (_cyphal_time_sync_master_enable &&
+     (now - _prev_time_sync_timepoint) > CYPHAL_TIME_SYNC_PERIOD)
+  {
+    uavcan::time::Synchronization_1_0 msg;
+
+    /* Carry the kernel TX timestamp of the previous sync transfer,
+     * or zero if none is known (i.e. this is the first transfer or
+     * the looped-back frame of the previous transfer got lost).
+     */
+    msg.previous_transmission_timestamp_microsecond = _cyphal_time_sync_tx_timestamp_usec.exchange(0);
+
+    _cyphal_time_sync_pub->publish(msg);
+
+    _prev_time_sync_timepoint = now;
+  }
+
+  bool is_remote_node_table_changed = false;
+  for (auto const node_id : _remote_node_table->checkOffline(now))
+  {
+    RCLCPP_WARN(get_logger(), "Cyphal node %d went offline.", node_id);
+    is_remote_node_table_changed = true;
+  }
+
+  if (is_remote_node_table_changed || (now - _prev_remote_node_table_timepoint) > REMOTE_NODE_TABLE_PUBLISH_PERIOD)
+    publish_remote_node_table();
 }
 
 /**************************************************************************************
@@ -184,15 +332,23 @@ void Node::init_cyphal_to_ros_angle_actual()
   {
     _angle_actual_ros_pub[port_id] = create_publisher<std_msgs::msg::Float32>(ros_topic, 1);
 
-    _angle_actual_cyphal_sub[port_id] = _node_hdl.create_subscription<uavcan::si::unit::angle::Scalar_1_0>(
+    init_cyphal_to_ros_channel(
       port_id,
-      [this, port_id](uavcan::si::unit::angle::Scalar_1_0 const & msg)
+      ros_topic,
+      [this, port_id](double const value)
       {
         std_msgs::msg::Float32 angle_actual_rad_msg;
-        angle_actual_rad_msg.data = msg.radian;
+        angle_actual_rad_msg.data = static_cast<float>(value);
         _angle_actual_ros_pub.at(port_id)->publish(angle_actual_rad_msg);
       });
 
+    _angle_actual_cyphal_sub[port_id] = _node_hdl.create_subscription<uavcan::si::unit::angle::Scalar_1_0>(
+      port_id,
+      [this, port_id](uavcan::si::unit::angle::Scalar_1_0 const & msg)
+      {
+        on_cyphal_to_ros_sample(port_id, msg.radian);
+      });
+
     RCLCPP_INFO(get_logger(), "Mapping [%d] to \"%s\"", port_id, ros_topic.c_str());
   }
 }
@@ -213,15 +369,23 @@ void Node::init_cyphal_to_ros_tibia_endpoint_switch()
   {
     _tibia_endpoint_switch_ros_pub[port_id] = create_publisher<std_msgs::msg::Bool>(ros_topic, 1);
 
-    _tibia_endpoint_switch_cyphal_sub[port_id] = _node_hdl.create_subscription<uavcan::primitive::scalar::Bit_1_0>(
+    init_cyphal_to_ros_channel(
       port_id,
-      [this, port_id](uavcan::primitive::scalar::Bit_1_0 const & msg)
+      ros_topic,
+      [this, port_id](double const value)
       {
         std_msgs::msg::Bool tibia_endpoint_switch_msg;
-        tibia_endpoint_switch_msg.data = msg.value;
+        tibia_endpoint_switch_msg.data = (value >= 0.5);
         _tibia_endpoint_switch_ros_pub.at(port_id)->publish(tibia_endpoint_switch_msg);
       });
 
+    _tibia_endpoint_switch_cyphal_sub[port_id] = _node_hdl.create_subscription<uavcan::primitive::scalar::Bit_1_0>(
+      port_id,
+      [this, port_id](uavcan::primitive::scalar::Bit_1_0 const & msg)
+      {
+        on_cyphal_to_ros_sample(port_id, msg.value ? 1.0 : 0.0);
+      });
+
     RCLCPP_INFO(get_logger(), "Mapping [%d] to \"%s\"", port_id, ros_topic.c_str());
   }
 }
@@ -233,15 +397,23 @@ void Node::init_cyphal_to_ros_estop()
 
   _estop_ros_pub = create_publisher<std_msgs::msg::Bool>(ROS_TOPIC, 1);
 
-  _estop_cyphal_sub = _node_hdl.create_subscription<uavcan::primitive::scalar::Bit_1_0>(
+  init_cyphal_to_ros_channel(
     PORT_ID,
-    [this](uavcan::primitive::scalar::Bit_1_0 const & msg)
+    ROS_TOPIC,
+    [this](double const value)
     {
       std_msgs::msg::Bool estop_msg;
-      estop_msg.data = msg.value;
+      estop_msg.data = (value >= 0.5);
       _estop_ros_pub->publish(estop_msg);
     });
 
+  _estop_cyphal_sub = _node_hdl.create_subscription<uavcan::primitive::scalar::Bit_1_0>(
+    PORT_ID,
+    [this, PORT_ID](uavcan::primitive::scalar::Bit_1_0 const & msg)
+    {
+      on_cyphal_to_ros_sample(PORT_ID, msg.value ? 1.0 : 0.0);
+    });
+
   RCLCPP_INFO(get_logger(), "Mapping [%d] to \"%s\"", PORT_ID, ROS_TOPIC.c_str());
 }
 
@@ -252,15 +424,23 @@ void Node::init_cyphal_to_ros_radiation_tick_cnt()
 
   _radiation_tick_cnt_ros_pub = create_publisher<std_msgs::msg::Int16>(ROS_TOPIC, 1);
 
-  _radiation_tick_cnt_cyphal_sub = _node_hdl.create_subscription<uavcan::primitive::scalar::Natural16_1_0>(
+  init_cyphal_to_ros_channel(
     PORT_ID,
-    [this](uavcan::primitive::scalar::Natural16_1_0 const & msg)
+    ROS_TOPIC,
+    [this](double const value)
     {
       std_msgs::msg::Int16 radiation_tick_msg;
-      radiation_tick_msg.data = msg.value;
+      radiation_tick_msg.data = static_cast<int16_t>(std::lround(value));
       _radiation_tick_cnt_ros_pub->publish(radiation_tick_msg);
     });
 
+  _radiation_tick_cnt_cyphal_sub = _node_hdl.create_subscription<uavcan::primitive::scalar::Natural16_1_0>(
+    PORT_ID,
+    [this, PORT_ID](uavcan::primitive::scalar::Natural16_1_0 const & msg)
+    {
+      on_cyphal_to_ros_sample(PORT_ID, msg.value);
+    });
+
   RCLCPP_INFO(get_logger(), "Mapping [%d] to \"%s\"", PORT_ID, ROS_TOPIC.c_str());
 }
 
@@ -273,15 +453,23 @@ void Node::init_cyphal_to_ros_pressure()
 
     _pressure_0_ros_pub = create_publisher<std_msgs::msg::Float32>(ROS_TOPIC, 1);
 
-    _pressure_0_cyphal_sub = _node_hdl.create_subscription<uavcan::si::unit::pressure::Scalar_1_0>(
+    init_cyphal_to_ros_channel(
       PORT_ID,
-      [this](uavcan::si::unit::pressure::Scalar_1_0 const & msg)
+      ROS_TOPIC,
+      [this](double const value)
       {
         std_msgs::msg::Float32 pressure_msg;
-        pressure_msg.data = msg.pascal;
+        pressure_msg.data = static_cast<float>(value);
         _pressure_0_ros_pub->publish(pressure_msg);
       });
 
+    _pressure_0_cyphal_sub = _node_hdl.create_subscription<uavcan::si::unit::pressure::Scalar_1_0>(
+      PORT_ID,
+      [this, PORT_ID](uavcan::si::unit::pressure::Scalar_1_0 const & msg)
+      {
+        on_cyphal_to_ros_sample(PORT_ID, msg.pascal);
+      });
+
     RCLCPP_INFO(get_logger(), "Mapping [%d] to \"%s\"", PORT_ID, ROS_TOPIC.c_str());
   }
 
@@ -292,15 +480,23 @@ void Node::init_cyphal_to_ros_pressure()
 
     _pressure_1_ros_pub = create_publisher<std_msgs::msg::Float32>(ROS_TOPIC, 1);
 
-    _pressure_1_cyphal_sub = _node_hdl.create_subscription<uavcan::si::unit::pressure::Scalar_1_0>(
+    init_cyphal_to_ros_channel(
       PORT_ID,
-      [this](uavcan::si::unit::pressure::Scalar_1_0 const & msg)
+      ROS_TOPIC,
+      [this](double const value)
       {
         std_msgs::msg::Float32 pressure_msg;
-        pressure_msg.data = msg.pascal;
+        pressure_msg.data = static_cast<float>(value);
         _pressure_1_ros_pub->publish(pressure_msg);
       });
 
+    _pressure_1_cyphal_sub = _node_hdl.create_subscription<uavcan::si::unit::pressure::Scalar_1_0>(
+      PORT_ID,
+      [this, PORT_ID](uavcan::si::unit::pressure::Scalar_1_0 const & msg)
+      {
+        on_cyphal_to_ros_sample(PORT_ID, msg.pascal);
+      });
+
     RCLCPP_INFO(get_logger(), "Mapping [%d] to \"%s\"", PORT_ID, ROS_TOPIC.c_str());
   }
 }
@@ -319,6 +515,8 @@ void Node::init_ros_to_cyphal_light_mode()
     {
       uavcan::primitive::scalar::Integer8_1_0 light_mode_msg;
       light_mode_msg.value = msg->data;
+
+      std::lock_guard<std::mutex> lock(_node_mtx);
       _light_mode_cyphal_pub->publish(light_mode_msg);
     });
 
@@ -330,7 +528,7 @@ void Node::init_ros_to_cyphal_servo_pulse_width()
   std::string const ROS_TOPIC = "/l3xz/servo_pulse_width/target";
   CanardPortID const PORT_ID = 4001U;
 
-  _servo_pulse_width_cyphal_pub = _node_hdl.create_publisher<uavcan::primitive::array::Natural16_1_0>(PORT_ID, 1*1000*1000UL /* = 1 sec in usecs. */);
+  _servo_pulse_width_cyphal_pub = _setpoint_node_hdl.create_publisher<uavcan::primitive::array::Natural16_1_0>(PORT_ID, 1*1000*1000UL /* = 1 sec in usecs. */);
 
   _servo_pulse_width_ros_sub = create_subscription<std_msgs::msg::UInt16MultiArray>(
     ROS_TOPIC,
@@ -345,7 +543,10 @@ void Node::init_ros_to_cyphal_servo_pulse_width()
         pulse_width_msg.value.push_back(pulse_width_us);
       }
 
+      std::lock_guard<std::mutex> lock(_setpoint_node_mtx);
+      cancel_trajectory();
       _servo_pulse_width_cyphal_pub->publish(pulse_width_msg);
+      transmit_setpoints();
     });
 
   RCLCPP_INFO(get_logger(), "Mapping [%d] to \"%s\"", PORT_ID, ROS_TOPIC.c_str());
@@ -365,6 +566,8 @@ void Node::init_ros_to_cyphal_pump_readiness()
     {
       reg::udral::service::common::Readiness_0_1 readiness_msg;
       readiness_msg.value = msg->data;
+
+      std::lock_guard<std::mutex> lock(_node_mtx);
       _pump_readiness_cyphal_pub->publish(readiness_msg);
     });
 
@@ -376,7 +579,7 @@ void Node::init_ros_to_cyphal_pump_setpoint()
   std::string const ROS_TOPIC = "/l3xz/pump/rpm/target";
   CanardPortID const PORT_ID = 5002U;
 
-  _pump_rpm_setpoint_cyphal_pub = _node_hdl.create_publisher<reg::udral::service::actuator::common::sp::Scalar_0_1>(PORT_ID, 1*1000*1000UL /* = 1 sec in usecs. */);
+  _pump_rpm_setpoint_cyphal_pub = _setpoint_node_hdl.create_publisher<reg::udral::service::actuator::common::sp::Scalar_0_1>(PORT_ID, 1*1000*1000UL /* = 1 sec in usecs. */);
 
   _pump_rpm_setpoint_ros_sub = create_subscription<std_msgs::msg::Float32>(
     ROS_TOPIC,
@@ -385,12 +588,405 @@ void Node::init_ros_to_cyphal_pump_setpoint()
     {
       reg::udral::service::actuator::common::sp::Scalar_0_1 rpm_setpoint_msg;
       rpm_setpoint_msg.value = msg->data;
+
+      std::lock_guard<std::mutex> lock(_setpoint_node_mtx);
+      cancel_trajectory();
       _pump_rpm_setpoint_cyphal_pub->publish(rpm_setpoint_msg);
+      transmit_setpoints();
     });
 
   RCLCPP_INFO(get_logger(), "Mapping [%d] to \"%s\"", PORT_ID, ROS_TOPIC.c_str());
 }
 
+void Node::init_shm_state()
+{
+  declare_parameter("shm_state_enable", true);
+  declare_parameter("shm_state_name", shm::DEFAULT_NAME);
+
+  if (!get_parameter("shm_state_enable").as_bool())
+    return;
+
+  _shm_state = std::make_unique<ShmStateWriter>(get_logger(), get_parameter("shm_state_name").as_string());
+
+  RCLCPP_INFO(get_logger(), "Writing state to shared memory segment \"%s\"", get_parameter("shm_state_name").as_string().c_str());
+}
+
+void Node::init_cyphal_to_ros_channel(CanardPortID const port_id, std::string const & ros_topic, SampleFilter::OnPublishFunc on_publish)
+{
+  /* Derive the parameter namespace from the ROS topic, i.e.
+   * "/l3xz/pressure_0/actual" is configured via "pressure_0.filter.*".
+   */
+  std::string filter_name = ros_topic;
+  if (filter_name.rfind("/l3xz/", 0) == 0)
+    filter_name.erase(0, std::string("/l3xz/").length());
+  if (auto const pos = filter_name.rfind("/actual"); pos != std::string::npos)
+    filter_name.erase(pos);
+  std::replace(filter_name.begin(), filter_name.end(), '/', '.');
+
+  std::string const param_prefix = filter_name + ".filter.";
+
+  declare_parameter(param_prefix + "enable", false);
+  declare_parameter(param_prefix + "deadband_abs", 0.0);
+  declare_parameter(param_prefix + "deadband_rel", 0.0);
+  declare_parameter(param_prefix + "rate_hz", 0.0);
+  declare_parameter(param_prefix + "window", "latest");
+  declare_parameter(param_prefix + "keepalive_ms", 1000);
+
+  std::string const window_str = get_parameter(param_prefix + "window").as_string();
+  auto const window = SampleFilter::toWindow(window_str);
+  if (!window.has_value())
+    throw std::runtime_error("Invalid value \"" + window_str + "\" for parameter \"" + param_prefix + "window\", expected latest|mean|min|max.");
+
+  SampleFilter::Config const cfg
+  {
+    get_parameter(param_prefix + "enable").as_bool(),
+    get_parameter(param_prefix + "deadband_abs").as_double(),
+    get_parameter(param_prefix + "deadband_rel").as_double(),
+    get_parameter(param_prefix + "rate_hz").as_double(),
+    window.value(),
+    std::chrono::milliseconds(get_parameter(param_prefix + "keepalive_ms").as_int())
+  };
+
+  _cyphal_to_ros_filter.emplace(port_id, SampleFilter(cfg, on_publish));
+  _cyphal_to_ros_rx_timestamp_usec[port_id] = 0;
+
+  if (_shm_state)
+    _shm_state->add(port_id, ros_topic);
+
+  if (cfg.enable)
+    RCLCPP_INFO(get_logger(),
+                "Filtering [%d] with\n\tDeadband (abs/rel): %f / %f\n\tRate: %f Hz\n\tWindow: %s\n\tKeepalive: %ld ms",
+                port_id,
+                cfg.deadband_abs,
+                cfg.deadband_rel,
+                cfg.rate_hz,
+                window_str.c_str(),
+                cfg.keepalive.count());
+}
+
+bool Node::transmit(CanardFrame const & frame)
+{
+  /* uavcan.time.Synchronization carries the TX timestamp of the
+   * previous sync frame, which is only meaningful for the medium
+   * it has been taken from, so it is confined to the first one.
+   */
+  bool const is_time_sync = (toSubjectId(frame) == CYPHAL_TIME_SYNC_PORT_ID);
+
+  /* Every transport queues (and retries) the frame on its own,
+   * a transport dropping the frame due to its queue being full
+   * reports this on its own. Reporting failure would make libcanard retry
+   * the frame on all transports, duplicating it on the others.
+   */
+  for (auto & transport : _transport)
+  {
+    if (is_time_sync && transport != _transport.front())
+      continue;
+
+    transport->transmit(frame);
+  }
+
+  return true;
+}
+
+void Node::on_cyphal_to_ros_sample(CanardPortID const port_id, double const value)
+{
+  if (_shm_state)
+  {
+    /* Prefer the kernel RX timestamp (CLOCK_REALTIME) of the frame
+     * over the time at which io_loop got around to processing it.
+     */
+    uint64_t timestamp_ns = _cyphal_to_ros_rx_timestamp_usec.at(port_id) * 1000;
+    if (timestamp_ns == 0)
+      timestamp_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+    _shm_state->update(port_id, value, timestamp_ns);
+  }
+
+  _cyphal_to_ros_filter.at(port_id).update(value, std::chrono::steady_clock::now());
+}
+
+void Node::on_frame_received(CanardFrame const & frame, CanardMicrosecond const timestamp_usec)
+{
+  std::lock_guard<std::mutex> lock(_node_mtx);
+
+  /* Remember the kernel RX timestamp of the latest frame of each
+   * Cyphal->ROS subject until the transfer is processed in io_loop.
+   */
+  if (auto const subject_id = toSubjectId(frame); subject_id.has_value())
+    if (auto const iter = _cyphal_to_ros_rx_timestamp_usec.find(subject_id.value()); iter != _cyphal_to_ros_rx_timestamp_usec.end())
+      iter->second = timestamp_usec;
+
+  _node_hdl.onCanFrameReceived(frame);
+}
+
+void Node::on_frame_transmitted(CanardFrame const & frame, CanardMicrosecond const timestamp_usec)
+{
+  /* uavcan.time.Synchronization always fits into a single
+   * frame, so the looped-back frame marks the transmission
+   * time of the whole transfer. It is only sent via a single
+   * transport, see transmit().
+   */
+  if (toSubjectId(frame) == CYPHAL_TIME_SYNC_PORT_ID)
+    _cyphal_time_sync_tx_timestamp_usec = timestamp_usec;
+}
+
+std::optional<CanardPortID> Node::toSubjectId(CanardFrame const & frame)
+{
+  /* Cyphal/CAN: bit 25 is set for service transfers,
+   * bits 8 to 20 contain the subject id of a message transfer.
+   */
+  bool const is_service = (frame.extended_can_id & (1UL << 25)) != 0;
+  if (is_service)
+    return std::nullopt;
+
+  return static_cast<CanardPortID>((frame.extended_can_id >> 8) & 0x1FFFUL);
+}
+
+void Node::init_ros_to_cyphal_trajectory()
+{
+  std::string const ROS_TOPIC = "/l3xz/trajectory/target";
+
+  declare_parameter("trajectory_period_us", 10*1000);
+  declare_parameter("trajectory_interpolation", "linear");
+  declare_parameter("trajectory_underrun_policy", "hold");
+  declare_parameter("trajectory_thread_priority", 0);
+
+  std::string const interpolation_str = get_parameter("trajectory_interpolation").as_string();
+  auto const interpolation = TrajectoryPlayer::toInterpolation(interpolation_str);
+  if (!interpolation.has_value())
+    throw std::runtime_error("Invalid value \"" + interpolation_str + "\" for parameter \"trajectory_interpolation\", expected step|linear.");
+
+  std::string const underrun_policy_str = get_parameter("trajectory_underrun_policy").as_string();
+  auto const underrun_policy = TrajectoryPlayer::toUnderrunPolicy(underrun_policy_str);
+  if (!underrun_policy.has_value())
+    throw std::runtime_error("Invalid value \"" + underrun_policy_str + "\" for parameter \"trajectory_underrun_policy\", expected hold|stop.");
+
+  _trajectory_player = std::make_unique<TrajectoryPlayer>(
+    get_logger(),
+    std::chrono::microseconds(get_parameter("trajectory_period_us").as_int()),
+    interpolation.value(),
+    underrun_policy.value(),
+    get_parameter("trajectory_thread_priority").as_int(),
+    [this](std::vector<double> const & values, uint64_t const generation) { on_trajectory_setpoint(values, generation); });
+
+  _trajectory_ros_sub = create_subscription<trajectory_msgs::msg::JointTrajectory>(
+    ROS_TOPIC,
+    10,
+    [this](trajectory_msgs::msg::JointTrajectory::SharedPtr const msg) { on_trajectory(*msg); });
+
+  RCLCPP_INFO(get_logger(),
+              "Playing out \"%s\" to [%d, %d] every %ld us",
+              ROS_TOPIC.c_str(),
+              4001U,
+              5002U,
+              get_parameter("trajectory_period_us").as_int());
+}
+
+void Node::on_trajectory(trajectory_msgs::msg::JointTrajectory const & msg)
+{
+  /* An empty trajectory cancels the playback. */
+  if (msg.points.empty()) {
+    std::lock_guard<std::mutex> lock(_setpoint_node_mtx);
+    cancel_trajectory();
+    return;
+  }
+
+  /* Joints are named "servo_<n>" (pulse width in us, published to
+   * port 4001 as element n) and "pump_rpm" (published to port 5002).
+   */
+  std::vector<size_t> servo_value_idx;
+  std::optional<size_t> pump_value_idx;
+  for (size_t i = 0; i < msg.joint_names.size(); i++)
+  {
+    std::string const & joint_name = msg.joint_names[i];
+    if (joint_name == "pump_rpm")
+      pump_value_idx = i;
+    else if (joint_name == "servo_" + std::to_string(servo_value_idx.size()))
+      servo_value_idx.push_back(i);
+    else {
+      RCLCPP_ERROR(get_logger(), "Rejecting trajectory with invalid joint name \"%s\", expected servo_<n> (in ascending order) or pump_rpm.", joint_name.c_str());
+      return;
+    }
+  }
+
+  auto const ros_now = get_clock()->now();
+  auto const steady_now = std::chrono::steady_clock::now();
+  rclcpp::Time const start = (msg.header.stamp.sec == 0 && msg.header.stamp.nanosec == 0) ?
+                             ros_now : rclcpp::Time(msg.header.stamp, get_clock()->get_clock_type());
+
+  std::vector<TrajectoryPlayer::Point> points;
+  rclcpp::Duration prev_time_from_start(0, 0);
+  for (auto const & ros_point : msg.points)
+  {
+    if (ros_point.positions.size() != msg.joint_names.size()) {
+      RCLCPP_ERROR(get_logger(), "Rejecting trajectory with %zu joint names but a point with %zu positions.", msg.joint_names.size(), ros_point.positions.size());
+      return;
+    }
+
+    rclcpp::Duration const time_from_start(ros_point.time_from_start);
+    if (!points.empty() && time_from_start <= prev_time_from_start) {
+      RCLCPP_ERROR(get_logger(), "Rejecting trajectory whose points are not strictly increasing in time_from_start.");
+      return;
+    }
+    prev_time_from_start = time_from_start;
+
+    rclcpp::Time const point_time = start + time_from_start;
+    TrajectoryPlayer::Point point;
+    point.time = steady_now + std::chrono::nanoseconds((point_time - ros_now).nanoseconds());
+    point.values = ros_point.positions;
+    points.push_back(point);
+  }
+
+  std::lock_guard<std::mutex> lock(_setpoint_node_mtx);
+
+  bool const is_joint_layout_changed = (msg.joint_names != _trajectory_joint_names);
+  if (is_joint_layout_changed)
+    _trajectory_generation++;
+
+  _trajectory_joint_names = msg.joint_names;
+  _trajectory_servo_value_idx = servo_value_idx;
+  _trajectory_pump_value_idx = pump_value_idx;
+
+  for (auto & point : points)
+    point.generation = _trajectory_generation;
+
+  _trajectory_player->load(points, is_joint_layout_changed);
+}
+
+void Node::on_trajectory_setpoint(std::vector<double> const & values, uint64_t const generation)
+{
+  std::lock_guard<std::mutex> lock(_setpoint_node_mtx);
+
+  /* Setpoint sampled before the joint layout has been changed
+   * or before the playback has been cancelled.
+   */
+  if (generation != _trajectory_generation)
+    return;
+
+  if (!_trajectory_servo_value_idx.empty())
+  {
+    uavcan::primitive::array::Natural16_1_0 pulse_width_msg;
+    for (size_t const idx : _trajectory_servo_value_idx)
+      pulse_width_msg.value.push_back(static_cast<uint16_t>(std::clamp(std::lround(values[idx]), 0L, 65535L)));
+    _servo_pulse_width_cyphal_pub->publish(pulse_width_msg);
+  }
+
+  if (_trajectory_pump_value_idx.has_value())
+  {
+    reg::udral::service::actuator::common::sp::Scalar_0_1 rpm_setpoint_msg;
+    rpm_setpoint_msg.value = values[_trajectory_pump_value_idx.value()];
+    _pump_rpm_setpoint_cyphal_pub->publish(rpm_setpoint_msg);
+  }
+
+  transmit_setpoints();
+}
+
+void Node::cancel_trajectory()
+{
+  /* Whichever input arrived last wins, a setpoint published
+   * directly cancels any trajectory which is still being played
+   * out (including one held past its last point). _setpoint_node_mtx
+   * must be held.
+   */
+  _trajectory_generation++;
+  _trajectory_player->clear();
+}
+
+void Node::transmit_setpoints()
+{
+  /* Transmit right away instead of waiting for the next io_loop
+   * invocation which is subject to executor jitter. _setpoint_node_hdl
+   * has no subscriptions, so this only drains its TX queue, and the
+   * transports never block. _setpoint_node_mtx must be held.
+   */
+  _setpoint_node_hdl.spinSome();
+  for (auto & transport : _transport)
+    transport->flush();
+}
+
+void Node::on_cyphal_heartbeat(uavcan::node::Heartbeat_1_0 const & msg, CanardNodeID const remote_node_id)
+{
+  /* Heartbeats of anonymous nodes (i.e. during PnP allocation). */
+  if (remote_node_id > CANARD_NODE_ID_MAX)
+    return;
+
+  if (_remote_node_table->update(remote_node_id,
+                                 msg.health.value,
+                                 msg.mode.value,
+                                 msg.uptime,
+                                 msg.vendor_specific_status_code,
+                                 std::chrono::steady_clock::now()))
+  {
+    RCLCPP_INFO(get_logger(), "Cyphal node %d is online.", remote_node_id);
+    publish_remote_node_table();
+  }
+}
+
+void Node::publish_remote_node_table()
+{
+  static std::map<uint8_t, std::string> const MODE_to_STR =
+    {
+      {uavcan::node::Mode_1_0::OPERATIONAL,     "OPERATIONAL"},
+      {uavcan::node::Mode_1_0::INITIALIZATION,  "INITIALIZATION"},
+      {uavcan::node::Mode_1_0::MAINTENANCE,     "MAINTENANCE"},
+      {uavcan::node::Mode_1_0::SOFTWARE_UPDATE, "SOFTWARE_UPDATE"},
+    };
+  static std::map<uint8_t, std::string> const HEALTH_to_STR =
+    {
+      {uavcan::node::Health_1_0::NOMINAL,  "NOMINAL"},
+      {uavcan::node::Health_1_0::ADVISORY, "ADVISORY"},
+      {uavcan::node::Health_1_0::CAUTION,  "CAUTION"},
+      {uavcan::node::Health_1_0::WARNING,  "WARNING"},
+    };
+  static std::map<uint8_t, uint8_t> const HEALTH_to_LEVEL =
+    {
+      {uavcan::node::Health_1_0::NOMINAL,  diagnostic_msgs::msg::DiagnosticStatus::OK},
+      {uavcan::node::Health_1_0::ADVISORY, diagnostic_msgs::msg::DiagnosticStatus::OK},
+      {uavcan::node::Health_1_0::CAUTION,  diagnostic_msgs::msg::DiagnosticStatus::WARN},
+      {uavcan::node::Health_1_0::WARNING,  diagnostic_msgs::msg::DiagnosticStatus::ERROR},
+    };
+
+  auto const to_key_value = [](std::string const & key, std::string const & value)
+  {
+    diagnostic_msgs::msg::KeyValue key_value;
+    key_value.key = key;
+    key_value.value = value;
+    return key_value;
+  };
+
+  diagnostic_msgs::msg::DiagnosticArray msg;
+  msg.header.stamp = get_clock()->now();
+
+  for (auto const & [node_id, entry] : _remote_node_table->entries())
+  {
+    diagnostic_msgs::msg::DiagnosticStatus status;
+
+    status.name = "cyphal_node_" + std::to_string(node_id);
+    status.hardware_id = std::to_string(node_id);
+
+    if (entry.is_online) {
+      status.level = HEALTH_to_LEVEL.count(entry.health) ? HEALTH_to_LEVEL.at(entry.health) : diagnostic_msgs::msg::DiagnosticStatus::ERROR;
+      status.message = "online";
+    } else {
+      status.level = diagnostic_msgs::msg::DiagnosticStatus::STALE;
+      status.message = "offline";
+    }
+
+    auto const last_seen_ms = std::chrono::duration_cast<std::chrono::milliseconds>(entry.last_seen_wall.time_since_epoch()).count();
+
+    status.values.push_back(to_key_value("health", HEALTH_to_STR.count(entry.health) ? HEALTH_to_STR.at(entry.health) : std::to_string(entry.health)));
+    status.values.push_back(to_key_value("mode", MODE_to_STR.count(entry.mode) ? MODE_to_STR.at(entry.mode) : std::to_string(entry.mode)));
+    status.values.push_back(to_key_value("uptime_s", std::to_string(entry.uptime)));
+    status.values.push_back(to_key_value("vendor_specific_status_code", std::to_string(entry.vendor_specific_status_code)));
+    status.values.push_back(to_key_value("last_seen_ms", std::to_string(last_seen_ms)));
+
+    msg.status.push_back(status);
+  }
+
+  _remote_node_table_ros_pub->publish(msg);
+  _prev_remote_node_table_timepoint = std::chrono::steady_clock::now();
+}
+
 CanardMicrosecond Node::micros()
 {
   auto const now = std::chrono::steady_clock::now();
@@ -0,0 +1,136 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <ros2_cyphal_bridge/PnpAllocationTable.h>
+
+#include <cstdio>
+#include <fstream>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+PnpAllocationTable::PnpAllocationTable(rclcpp::Logger const logger,
+                                       std::string const & file_name,
+                                       uint8_t const node_id_min,
+                                       uint8_t const node_id_max)
+: _logger{logger}
+, FILE_NAME{file_name}
+, NODE_ID_MIN{node_id_min}
+, NODE_ID_MAX{node_id_max}
+, _table{}
+{
+  load();
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+std::optional<uint8_t> PnpAllocationTable::allocate(uint64_t const unique_id_hash,
+                                                    std::set<uint8_t> const & reserved_node_ids,
+                                                    std::set<uint8_t> const & online_node_ids)
+{
+  if (auto const iter = _table.find(unique_id_hash); iter != _table.end())
+  {
+    uint8_t const node_id = iter->second;
+    bool const is_in_range = (node_id >= NODE_ID_MIN) && (node_id <= NODE_ID_MAX);
+
+    /* The persisted node id belongs to this very node, an online node
+     * with that id is most likely the same node before its restart.
+     */
+    if (is_in_range && !reserved_node_ids.count(node_id))
+      return node_id;
+
+    /* The persisted node id has been taken by the bridge itself or
+     * lies outside of the (re-configured) range, hand out a new one.
+     */
+    RCLCPP_WARN(_logger,
+                "PnP: node id %d of unique id hash %012lx is %s, reallocating.",
+                node_id,
+                unique_id_hash,
+                is_in_range ? "reserved" : "out of range");
+    _table.erase(iter);
+  }
+
+  std::set<uint8_t> allocated_node_ids;
+  for (auto const & [hash, node_id] : _table)
+    allocated_node_ids.insert(node_id);
+
+  /* Allocate from the top of the range downwards, as
+   * recommended by the Cyphal specification.
+   */
+  for (int node_id = NODE_ID_MAX; node_id >= NODE_ID_MIN; node_id--)
+  {
+    if (allocated_node_ids.count(node_id) || reserved_node_ids.count(node_id) || online_node_ids.count(node_id))
+      continue;
+
+    _table[unique_id_hash] = static_cast<uint8_t>(node_id);
+    store();
+    return static_cast<uint8_t>(node_id);
+  }
+
+  return std::nullopt;
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void PnpAllocationTable::load()
+{
+  std::ifstream file(FILE_NAME);
+  if (!file.is_open()) {
+    RCLCPP_INFO(_logger, "No PnP allocation table found at \"%s\", starting with an empty one.", FILE_NAME.c_str());
+    return;
+  }
+
+  /* One allocation per line: "<unique id hash (hex)> <node id>". */
+  uint64_t unique_id_hash = 0;
+  unsigned int node_id = 0;
+  while (file >> std::hex >> unique_id_hash >> std::dec >> node_id)
+    _table[unique_id_hash] = static_cast<uint8_t>(node_id);
+
+  RCLCPP_INFO(_logger, "Loaded %zu PnP allocation(s) from \"%s\".", _table.size(), FILE_NAME.c_str());
+}
+
+void PnpAllocationTable::store()
+{
+  /* Write to a temporary file first and rename it afterwards,
+   * so that the table is not lost if we die half-way through.
+   */
+  std::string const tmp_file_name = FILE_NAME + ".tmp";
+  {
+    std::ofstream file(tmp_file_name, std::ios::trunc);
+    for (auto const & [unique_id_hash, node_id] : _table)
+      file << std::hex << unique_id_hash << " " << std::dec << static_cast<unsigned int>(node_id) << "\n";
+
+    if (!file.good()) {
+      RCLCPP_ERROR(_logger, "Error writing PnP allocation table to \"%s\".", tmp_file_name.c_str());
+      return;
+    }
+  }
+
+  if (std::rename(tmp_file_name.c_str(), FILE_NAME.c_str()) != 0)
+    RCLCPP_ERROR(_logger, "Error renaming \"%s\" to \"%s\".", tmp_file_name.c_str(), FILE_NAME.c_str());
+}
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */
@@ -0,0 +1,86 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <ros2_cyphal_bridge/RemoteNodeTable.h>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+RemoteNodeTable::RemoteNodeTable(std::chrono::milliseconds const offline_timeout)
+: OFFLINE_TIMEOUT{offline_timeout}
+, _table{}
+{
+
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+bool RemoteNodeTable::update(uint8_t const node_id,
+                             uint8_t const health,
+                             uint8_t const mode,
+                             uint32_t const uptime,
+                             uint8_t const vendor_specific_status_code,
+                             std::chrono::steady_clock::time_point const now)
+{
+  auto const iter = _table.find(node_id);
+  bool const is_discovered = (iter == _table.end()) || !iter->second.is_online;
+
+  Entry & entry = _table[node_id];
+  entry.health = health;
+  entry.mode = mode;
+  entry.uptime = uptime;
+  entry.vendor_specific_status_code = vendor_specific_status_code;
+  entry.last_seen = now;
+  entry.last_seen_wall = std::chrono::system_clock::now();
+  entry.is_online = true;
+
+  return is_discovered;
+}
+
+std::vector<uint8_t> RemoteNodeTable::checkOffline(std::chrono::steady_clock::time_point const now)
+{
+  std::vector<uint8_t> offline_node_ids;
+
+  for (auto & [node_id, entry] : _table)
+    if (entry.is_online && (now - entry.last_seen) > OFFLINE_TIMEOUT)
+    {
+      entry.is_online = false;
+      offline_node_ids.push_back(node_id);
+    }
+
+  return offline_node_ids;
+}
+
+std::set<uint8_t> RemoteNodeTable::online() const
+{
+  std::set<uint8_t> online_node_ids;
+
+  for (auto const & [node_id, entry] : _table)
+    if (entry.is_online)
+      online_node_ids.insert(node_id);
+
+  return online_node_ids;
+}
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */
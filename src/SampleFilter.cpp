@@ -0,0 +1,140 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <ros2_cyphal_bridge/SampleFilter.h>
+
+#include <cmath>
+#include <algorithm>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+SampleFilter::SampleFilter(Config const & cfg, OnPublishFunc on_publish)
+: _cfg{cfg}
+, _window_period{(cfg.rate_hz > 0.0) ?
+                 std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double>(1.0 / cfg.rate_hz)) :
+                 std::chrono::steady_clock::duration::zero()}
+, _on_publish{on_publish}
+, _window_cnt{0}
+, _window_sum{0.0}
+, _window_min{0.0}
+, _window_max{0.0}
+, _window_latest{0.0}
+, _window_start{}
+, _prev_published{std::nullopt}
+, _prev_publish_timepoint{}
+{
+
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void SampleFilter::update(double const sample, std::chrono::steady_clock::time_point const now)
+{
+  if (!_cfg.enable) {
+    publish(sample, now);
+    return;
+  }
+
+  if (_window_cnt == 0)
+  {
+    _window_start = now;
+    _window_sum = 0.0;
+    _window_min = sample;
+    _window_max = sample;
+  }
+
+  _window_cnt++;
+  _window_sum += sample;
+  _window_min = std::min(_window_min, sample);
+  _window_max = std::max(_window_max, sample);
+  _window_latest = sample;
+
+  if ((now - _window_start) >= _window_period)
+    close_window(now);
+}
+
+void SampleFilter::spin(std::chrono::steady_clock::time_point const now)
+{
+  /* Close a window whose period has expired even if no
+   * further sample arrives to trigger it from update().
+   */
+  if (_cfg.enable && _window_cnt > 0 && (now - _window_start) >= _window_period)
+    close_window(now);
+}
+
+std::optional<SampleFilter::Window> SampleFilter::toWindow(std::string const & window_str)
+{
+  if      (window_str == "latest") return Window::Latest;
+  else if (window_str == "mean")   return Window::Mean;
+  else if (window_str == "min")    return Window::Min;
+  else if (window_str == "max")    return Window::Max;
+  else                             return std::nullopt;
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void SampleFilter::close_window(std::chrono::steady_clock::time_point const now)
+{
+  double const value = reduce_window();
+  _window_cnt = 0;
+
+  bool const is_keepalive_due = (_cfg.keepalive.count() > 0) && ((now - _prev_publish_timepoint) >= _cfg.keepalive);
+
+  if (!_prev_published.has_value() || is_outside_deadband(value))
+    publish(value, now);
+  else if (is_keepalive_due)
+    publish(_prev_published.value(), now);
+}
+
+double SampleFilter::reduce_window() const
+{
+  switch (_cfg.window)
+  {
+    case Window::Latest: return _window_latest;
+    case Window::Mean:   return _window_sum / static_cast<double>(_window_cnt);
+    case Window::Min:    return _window_min;
+    case Window::Max:    return _window_max;
+  }
+  return _window_latest;
+}
+
+bool SampleFilter::is_outside_deadband(double const value) const
+{
+  double const prev = _prev_published.value();
+  double const deadband = std::max(_cfg.deadband_abs, _cfg.deadband_rel * std::fabs(prev));
+  /* A deadband of zero degenerates to publish-on-change. */
+  return std::fabs(value - prev) > deadband;
+}
+
+void SampleFilter::publish(double const value, std::chrono::steady_clock::time_point const now)
+{
+  _on_publish(value);
+  _prev_published = value;
+  _prev_publish_timepoint = now;
+}
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */
@@ -0,0 +1,139 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <ros2_cyphal_bridge/ShmStateWriter.h>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+
+#include <new>
+#include <cstring>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+ShmStateWriter::ShmStateWriter(rclcpp::Logger const logger, std::string const & name)
+: _logger{logger}
+, SHM_NAME{name}
+, _segment{nullptr}
+, _port_id_to_entry{}
+{
+  int const fd = shm_open(SHM_NAME.c_str(), O_CREAT | O_RDWR, 0644);
+  if (fd < 0) {
+    RCLCPP_ERROR(_logger, "'shm_open(\"%s\")' failed with error %s.", SHM_NAME.c_str(), strerror(errno));
+    rclcpp::shutdown();
+    return;
+  }
+
+  if (ftruncate(fd, sizeof(shm::Segment)) < 0) {
+    RCLCPP_ERROR(_logger, "'ftruncate' failed with error %s.", strerror(errno));
+    close(fd);
+    rclcpp::shutdown();
+    return;
+  }
+
+  void * addr = mmap(nullptr, sizeof(shm::Segment), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  /* The mapping stays valid after closing the file descriptor. */
+  close(fd);
+
+  if (addr == MAP_FAILED) {
+    RCLCPP_ERROR(_logger, "'mmap' failed with error %s.", strerror(errno));
+    rclcpp::shutdown();
+    return;
+  }
+
+  _segment = new (addr) shm::Segment;
+
+  /* Invalidate the segment (which might be left over from a
+   * previous run) before re-initializing it.
+   */
+  _segment->magic.store(0, std::memory_order_relaxed);
+  _segment->version.store(shm::VERSION, std::memory_order_relaxed);
+  _segment->seq.store(0, std::memory_order_relaxed);
+  _segment->num_entries.store(0, std::memory_order_relaxed);
+  _segment->magic.store(shm::MAGIC, std::memory_order_release);
+}
+
+ShmStateWriter::~ShmStateWriter()
+{
+  if (_segment == nullptr)
+    return;
+
+  _segment->magic.store(0, std::memory_order_release);
+  munmap(_segment, sizeof(shm::Segment));
+  shm_unlink(SHM_NAME.c_str());
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void ShmStateWriter::add(uint16_t const port_id, std::string const & topic)
+{
+  if (_segment == nullptr)
+    return;
+
+  size_t const idx = _segment->num_entries.load(std::memory_order_relaxed);
+  if (idx >= shm::MAX_ENTRIES) {
+    RCLCPP_ERROR(_logger, "Can not add [%d] to shared memory state segment, all %zu entries are in use.", port_id, shm::MAX_ENTRIES);
+    return;
+  }
+
+  shm::Entry & entry = _segment->entry[idx];
+  entry.port_id.store(port_id, std::memory_order_relaxed);
+  entry.value.store(0, std::memory_order_relaxed);
+  entry.timestamp_ns.store(0, std::memory_order_relaxed);
+  entry.sample_cnt.store(0, std::memory_order_relaxed);
+  memset(entry.topic, 0, sizeof(entry.topic));
+  strncpy(entry.topic, topic.c_str(), sizeof(entry.topic) - 1);
+
+  _port_id_to_entry[port_id] = idx;
+  _segment->num_entries.store(idx + 1, std::memory_order_release);
+}
+
+void ShmStateWriter::update(uint16_t const port_id, double const value, uint64_t const timestamp_ns)
+{
+  if (_segment == nullptr)
+    return;
+
+  auto const iter = _port_id_to_entry.find(port_id);
+  if (iter == _port_id_to_entry.end())
+    return;
+
+  shm::Entry & entry = _segment->entry[iter->second];
+
+  uint64_t value_bits = 0;
+  memcpy(&value_bits, &value, sizeof(value_bits));
+
+  uint64_t const seq = _segment->seq.load(std::memory_order_relaxed);
+  _segment->seq.store(seq + 1, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+
+  entry.value.store(value_bits, std::memory_order_relaxed);
+  entry.timestamp_ns.store(timestamp_ns, std::memory_order_relaxed);
+  entry.sample_cnt.store(entry.sample_cnt.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+  _segment->seq.store(seq + 2, std::memory_order_release);
+}
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */
@@ -0,0 +1,197 @@
+/**
+ * Copyright (c) 2022 LXRobotics GmbH.
+ * Author: Alexander Entinger <alexander.entinger@lxrobotics.com>
+ * Contributors: https://github.com/107-systems/ros2_cyphal_bridge/graphs/contributors.
+ */
+
+/**************************************************************************************
+ * INCLUDES
+ **************************************************************************************/
+
+#include <ros2_cyphal_bridge/TrajectoryPlayer.h>
+
+#include <time.h>
+#include <pthread.h>
+
+#include <cstring>
+#include <algorithm>
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+namespace l3xz
+{
+
+/**************************************************************************************
+ * CTOR/DTOR
+ **************************************************************************************/
+
+TrajectoryPlayer::TrajectoryPlayer(rclcpp::Logger const logger,
+                                   std::chrono::microseconds const period,
+                                   Interpolation const interpolation,
+                                   UnderrunPolicy const underrun_policy,
+                                   int const thread_priority,
+                                   OnSetpointFunc on_setpoint)
+: _logger{logger}
+, PERIOD{period}
+, INTERPOLATION{interpolation}
+, UNDERRUN_POLICY{underrun_policy}
+, _on_setpoint{on_setpoint}
+, _clock{RCL_STEADY_TIME}
+, _points_mtx{}
+, _points{}
+, _is_underrun{false}
+, _thread_active{true}
+, _thread{[this, thread_priority]() { this->thread_func(thread_priority); }}
+{
+
+}
+
+TrajectoryPlayer::~TrajectoryPlayer()
+{
+  _thread_active = false;
+  _thread.join();
+}
+
+/**************************************************************************************
+ * PUBLIC MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void TrajectoryPlayer::load(std::vector<Point> const & points, bool const replace_all)
+{
+  std::lock_guard<std::mutex> lock(_points_mtx);
+
+  if (replace_all)
+    _points.clear();
+  else if (!points.empty())
+  {
+    auto const first_new_time = points.front().time;
+    while (!_points.empty() && _points.back().time >= first_new_time)
+      _points.pop_back();
+  }
+
+  std::copy(points.begin(), points.end(), std::back_inserter(_points));
+  _is_underrun = false;
+}
+
+void TrajectoryPlayer::clear()
+{
+  std::lock_guard<std::mutex> lock(_points_mtx);
+  _points.clear();
+}
+
+std::optional<TrajectoryPlayer::Interpolation> TrajectoryPlayer::toInterpolation(std::string const & interpolation_str)
+{
+  if      (interpolation_str == "step")   return Interpolation::Step;
+  else if (interpolation_str == "linear") return Interpolation::Linear;
+  else                                    return std::nullopt;
+}
+
+std::optional<TrajectoryPlayer::UnderrunPolicy> TrajectoryPlayer::toUnderrunPolicy(std::string const & underrun_policy_str)
+{
+  if      (underrun_policy_str == "hold") return UnderrunPolicy::Hold;
+  else if (underrun_policy_str == "stop") return UnderrunPolicy::Stop;
+  else                                    return std::nullopt;
+}
+
+/**************************************************************************************
+ * PRIVATE MEMBER FUNCTIONS
+ **************************************************************************************/
+
+void TrajectoryPlayer::thread_func(int const thread_priority)
+{
+  if (thread_priority > 0)
+  {
+    sched_param param{};
+    param.sched_priority = thread_priority;
+    if (int const rc = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param); rc != 0)
+      RCLCPP_WARN(_logger, "'pthread_setschedparam(SCHED_FIFO, %d)' failed with error %s, continuing with default scheduling.", thread_priority, strerror(rc));
+  }
+
+  timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC, &deadline);
+
+  while (_thread_active)
+  {
+    /* Advance the absolute deadline by one period, sleeping
+     * until an absolute point in time avoids accumulating the
+     * wake-up latency of each cycle.
+     */
+    deadline.tv_nsec += std::chrono::duration_cast<std::chrono::nanoseconds>(PERIOD).count();
+    while (deadline.tv_nsec >= 1000*1000*1000L) {
+      deadline.tv_nsec -= 1000*1000*1000L;
+      deadline.tv_sec++;
+    }
+
+    timespec now_ts;
+    clock_gettime(CLOCK_MONOTONIC, &now_ts);
+    if ((now_ts.tv_sec > deadline.tv_sec) || (now_ts.tv_sec == deadline.tv_sec && now_ts.tv_nsec > deadline.tv_nsec))
+    {
+      /* We have fallen behind (i.e. the thread got preempted),
+       * skip the missed periods instead of bursting them out.
+       */
+      RCLCPP_WARN_THROTTLE(_logger, _clock, 1000, "trajectory playback missed its deadline");
+      deadline = now_ts;
+    }
+    else
+      clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &deadline, nullptr);
+
+    /* _points_mtx is released before invoking the callback, which
+     * may take locks under which load() or clear() are called.
+     */
+    if (auto const point = sample(std::chrono::steady_clock::now()); point.has_value())
+      _on_setpoint(point->values, point->generation);
+  }
+}
+
+std::optional<TrajectoryPlayer::Point> TrajectoryPlayer::sample(std::chrono::steady_clock::time_point const now)
+{
+  std::lock_guard<std::mutex> lock(_points_mtx);
+
+  /* Discard all points which are already in the past,
+   * except the one right before now.
+   */
+  while (_points.size() >= 2 && _points[1].time <= now)
+    _points.pop_front();
+
+  if (_points.empty() || now < _points.front().time)
+    return std::nullopt;
+
+  if (_points.size() == 1)
+  {
+    if (!_is_underrun)
+      RCLCPP_DEBUG(_logger, "trajectory buffer underrun");
+    _is_underrun = true;
+
+    Point const point = _points.front();
+    if (UNDERRUN_POLICY == UnderrunPolicy::Stop)
+      _points.clear();
+    return point;
+  }
+
+  Point const & prev = _points[0];
+  Point const & next = _points[1];
+
+  if (INTERPOLATION == Interpolation::Step ||
+      prev.generation != next.generation ||
+      prev.values.size() != next.values.size())
+    return prev;
+
+  double const alpha = std::chrono::duration<double>(now - prev.time).count() /
+                       std::chrono::duration<double>(next.time - prev.time).count();
+
+  Point point;
+  point.time = now;
+  point.values.resize(prev.values.size());
+  point.generation = prev.generation;
+  for (size_t i = 0; i < point.values.size(); i++)
+    point.values[i] = prev.values[i] + alpha * (next.values[i] - prev.values[i]);
+  return point;
+}
+
+/**************************************************************************************
+ * NAMESPACE
+ **************************************************************************************/
+
+} /* l3xz */